@@ -118,11 +118,11 @@ struct Project
 				line.erase(0, 1);
 				matchFiles(std::move(line), cpps, [](soup::AtomicStack<std::filesystem::path>& cpps, std::filesystem::path file)
 				{
-					for (auto node = cpps.head.load(); node != nullptr; node = node->next)
+					for (auto node = cpps.front(); node != nullptr; node = cpps.next(node))
 					{
 						if (node->data == file)
 						{
-							cpps.erase(node);
+							cpps.erase(cpps.getHandle(node));
 							break;
 						}
 					}
@@ -260,7 +260,7 @@ struct Project
 		}
 		if (cpps.size() == 1)
 		{
-			auto name = get_name_no_extension(cpps.head.load()->data);
+			auto name = get_name_no_extension(cpps.front()->data);
 			if (name != "main")
 			{
 				return name;
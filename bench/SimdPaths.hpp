@@ -0,0 +1,39 @@
+#pragma once
+
+#include <soup/base.hpp>
+#include <soup/CpuInfo.hpp>
+
+// Soup picks SIMD kernels at runtime based on CpuInfo, so by hiding features from it, every kernel can be checked and timed on the same machine.
+
+struct SimdPath
+{
+	const char* name;
+	bool ssse3;
+	bool avx2;
+};
+
+inline const SimdPath simd_paths[] = {
+	{ "scalar", false, false },
+	{ "ssse3", true, false },
+	{ "avx2", true, true },
+};
+
+// Returns false if the CPU doesn't support the path.
+inline bool useSimdPath(const SimdPath& path)
+{
+#if SOUP_X86
+	static const soup::CpuInfo original = soup::CpuInfo::get();
+	if ((path.ssse3 && !original.supportsSSSE3())
+		|| (path.avx2 && !original.supportsAVX2())
+		)
+	{
+		return false;
+	}
+	auto& info = const_cast<soup::CpuInfo&>(soup::CpuInfo::get());
+	info.feature_flags_ecx = (path.ssse3 ? original.feature_flags_ecx : (original.feature_flags_ecx & ~(1u << 9)));
+	info.extended_features_0_ebx = (path.avx2 ? original.extended_features_0_ebx : (original.extended_features_0_ebx & ~(1u << 5)));
+	return true;
+#else
+	return !path.ssse3 && !path.avx2;
+#endif
+}
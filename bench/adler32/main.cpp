@@ -0,0 +1,127 @@
+// Checks the SSSE3 and AVX2 Adler-32 kernels and adler32::combine bit-for-bit against the scalar kernel, then measures throughput.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <soup/adler32.hpp>
+
+#include "../SimdPaths.hpp"
+
+using namespace soup;
+
+static constexpr size_t NMAX = 5552;
+
+static std::vector<uint8_t> randomBytes(size_t size, std::mt19937& rng)
+{
+	std::vector<uint8_t> data(size);
+	for (auto& b : data)
+	{
+		b = (uint8_t)rng();
+	}
+	return data;
+}
+
+static unsigned int checkPath(const SimdPath& path, const std::vector<uint8_t>& random, const std::vector<uint8_t>& ones, const std::vector<uint32_t>& expected_random, const std::vector<uint32_t>& expected_ones, const std::vector<size_t>& sizes, const std::vector<uint32_t>& inits)
+{
+	unsigned int failures = 0;
+	size_t i = 0;
+	for (size_t size : sizes)
+	{
+		for (size_t misalign = 0; misalign != 4; ++misalign)
+		{
+			for (uint32_t init : inits)
+			{
+				const uint32_t r = adler32::hash(&random[misalign], size, init);
+				const uint32_t o = adler32::hash(&ones[misalign], size, init);
+				if (r != expected_random[i] || o != expected_ones[i])
+				{
+					std::printf("FAIL %s: size %zu, misalign %zu, init %08x\n", path.name, size, misalign, init);
+					++failures;
+				}
+				++i;
+			}
+		}
+	}
+	return failures;
+}
+
+static unsigned int checkCombine(const std::vector<uint8_t>& data, std::mt19937& rng)
+{
+	unsigned int failures = 0;
+	for (int i = 0; i != 2000; ++i)
+	{
+		const size_t size = rng() % (3 * NMAX);
+		const size_t split = (size == 0 ? 0 : rng() % (size + 1));
+		const uint32_t whole = adler32::hash(data.data(), size);
+		const uint32_t a = adler32::hash(data.data(), split);
+		const uint32_t b = adler32::hash(data.data() + split, size - split);
+		if (adler32::combine(a, b, size - split) != whole)
+		{
+			std::printf("FAIL combine: size %zu, split %zu\n", size, split);
+			++failures;
+		}
+	}
+	return failures;
+}
+
+int main()
+{
+	std::mt19937 rng(42);
+	const std::vector<size_t> sizes = {
+		0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 1000,
+		NMAX - 1, NMAX, NMAX + 1, 2 * NMAX - 33, 2 * NMAX + 7, 100000, (1 << 20) + 3,
+	};
+	const std::vector<uint32_t> inits = { adler32::INITIAL, 0xFFF0FFF0, 0x9ABC5678 };
+	const std::vector<uint8_t> random = randomBytes((1 << 20) + 8, rng);
+	const std::vector<uint8_t> ones((1 << 20) + 8, 0xFF);
+
+	// Reference values from the scalar kernel.
+	useSimdPath(simd_paths[0]);
+	std::vector<uint32_t> expected_random, expected_ones;
+	for (size_t size : sizes)
+	{
+		for (size_t misalign = 0; misalign != 4; ++misalign)
+		{
+			for (uint32_t init : inits)
+			{
+				expected_random.emplace_back(adler32::hash(&random[misalign], size, init));
+				expected_ones.emplace_back(adler32::hash(&ones[misalign], size, init));
+			}
+		}
+	}
+
+	unsigned int failures = 0;
+	for (const auto& path : simd_paths)
+	{
+		if (!useSimdPath(path))
+		{
+			std::printf("Skipping %s, not supported by this CPU.\n", path.name);
+			continue;
+		}
+		failures += checkPath(path, random, ones, expected_random, expected_ones, sizes, inits);
+		failures += checkCombine(random, rng);
+	}
+	std::printf("%s\n", failures == 0 ? "All checks passed." : "Checks FAILED.");
+
+	const std::vector<uint8_t> big = randomBytes(64 << 20, rng);
+	for (const auto& path : simd_paths)
+	{
+		if (!useSimdPath(path))
+		{
+			continue;
+		}
+		uint32_t sink = 0;
+		const auto start = std::chrono::steady_clock::now();
+		constexpr int iterations = 10;
+		for (int i = 0; i != iterations; ++i)
+		{
+			sink += adler32::hash(big.data(), big.size());
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%-6s %8.0f MB/s (%08x)\n", path.name, (double)big.size() * iterations / seconds / 1e6, sink);
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+// Contention benchmark for AtomicStack and AtomicRingQueue, with a mutex-guarded std::vector as a baseline.
+// For each thread count N from 1 to hardware_concurrency (or the first argument), N producers and N consumers pass ITEMS integers through the container.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <soup/AtomicRingQueue.hpp>
+#include <soup/AtomicStack.hpp>
+
+using namespace soup;
+
+static constexpr size_t ITEMS = 2'000'000;
+
+struct StackAdapter
+{
+	AtomicStack<size_t> s;
+
+	bool push(size_t v)
+	{
+		s.emplace_front(std::move(v));
+		return true;
+	}
+
+	bool pop(size_t& v)
+	{
+		auto node = s.pop_front();
+		if (!node)
+		{
+			return false;
+		}
+		v = *node;
+		return true;
+	}
+};
+
+struct QueueAdapter
+{
+	AtomicRingQueue<size_t> q{ 1024 };
+
+	bool push(size_t v)
+	{
+		return q.try_emplace(std::move(v));
+	}
+
+	bool pop(size_t& v)
+	{
+		return q.try_pop(v);
+	}
+};
+
+struct MutexAdapter
+{
+	std::mutex mtx;
+	std::vector<size_t> vec;
+
+	bool push(size_t v)
+	{
+		std::lock_guard lock(mtx);
+		vec.emplace_back(v);
+		return true;
+	}
+
+	bool pop(size_t& v)
+	{
+		std::lock_guard lock(mtx);
+		if (vec.empty())
+		{
+			return false;
+		}
+		v = vec.back();
+		vec.pop_back();
+		return true;
+	}
+};
+
+// Returns millions of items passed per second, or a negative value if items were lost or duplicated.
+template <typename Adapter>
+static double run(unsigned int threads)
+{
+	Adapter container;
+	std::atomic_size_t consumed = 0;
+	std::atomic_size_t sum = 0;
+	std::vector<std::thread> workers;
+	const size_t per_producer = ITEMS / threads;
+	const size_t total = per_producer * threads;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int t = 0; t != threads; ++t)
+	{
+		workers.emplace_back([&, t]
+		{
+			for (size_t i = 0; i != per_producer; ++i)
+			{
+				while (!container.push(t * per_producer + i))
+				{
+					std::this_thread::yield(); // bounded queue is full
+				}
+			}
+		});
+		workers.emplace_back([&]
+		{
+			size_t local_sum = 0;
+			size_t v;
+			while (consumed.load(std::memory_order_relaxed) != total)
+			{
+				if (container.pop(v))
+				{
+					local_sum += v;
+					consumed.fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+			sum.fetch_add(local_sum);
+		});
+	}
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (sum.load() != total * (total - 1) / 2)
+	{
+		return -1.0;
+	}
+	return (double)total / seconds / 1e6;
+}
+
+int main(int argc, const char** argv)
+{
+	const unsigned int max_threads = std::max(1u, (argc > 1 ? (unsigned int)std::atoi(argv[1]) : std::thread::hardware_concurrency()));
+	bool ok = true;
+	std::printf("threads  AtomicStack  AtomicRingQueue  mutex+vector  (M items/s, N producers + N consumers)\n");
+	for (unsigned int threads = 1; threads <= max_threads; ++threads)
+	{
+		const double stack = run<StackAdapter>(threads);
+		const double queue = run<QueueAdapter>(threads);
+		const double mutex = run<MutexAdapter>(threads);
+		ok &= (stack >= 0 && queue >= 0 && mutex >= 0);
+		std::printf("%7u  %11.2f  %15.2f  %12.2f\n", threads, stack, queue, mutex);
+	}
+	if (!ok)
+	{
+		std::printf("FAILED: items were lost or duplicated.\n");
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// Checks Canvas' row-span kernels against straightforward per-pixel versions of the same operations, then times both.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include <soup/Canvas.hpp>
+#include <soup/RasterFont.hpp>
+#include <soup/Rgb.hpp>
+
+using namespace soup;
+
+// Reference implementations, going through Canvas::set & Canvas::get for every pixel.
+
+static void refFill(Canvas& c, Rgb colour)
+{
+	for (unsigned int y = 0; y != c.height; ++y)
+	{
+		for (unsigned int x = 0; x != c.width; ++x)
+		{
+			c.set(x, y, colour);
+		}
+	}
+}
+
+static void refAddRect(Canvas& c, unsigned int x_offset, unsigned int y_offset, unsigned int width, unsigned int height, Rgb colour)
+{
+	for (unsigned int y = 0; y != height; ++y)
+	{
+		for (unsigned int x = 0; x != width; ++x)
+		{
+			c.set(x + x_offset, y + y_offset, colour);
+		}
+	}
+}
+
+static void refAddCanvas(Canvas& c, unsigned int x_offset, unsigned int y_offset, const Canvas& b)
+{
+	for (unsigned int y = 0; y != b.height; ++y)
+	{
+		for (unsigned int x = 0; x != b.width; ++x)
+		{
+			c.set(x + x_offset, y + y_offset, b.get(x, y));
+		}
+	}
+}
+
+static void refAddText(Canvas& c, unsigned int x, unsigned int y, const std::u32string& text, const RasterFont& font)
+{
+	for (const auto& ch : text)
+	{
+		const auto& g = font.get(ch);
+		refAddCanvas(c, x, y + g.y_offset, Canvas(g.width, g.height, g.pixels));
+		x += (g.width + 1);
+	}
+}
+
+// Source coordinate is floor(dst * src_size / dst_size) in exact integer arithmetic.
+// The old implementation computed this in double, which could round down one pixel too far.
+static void refResizeNearestNeighbour(Canvas& c, unsigned int desired_width, unsigned int desired_height)
+{
+	Canvas res{ desired_width, desired_height };
+	for (unsigned int y = 0; y != desired_height; ++y)
+	{
+		for (unsigned int x = 0; x != desired_width; ++x)
+		{
+			res.set(x, y, c.get(
+				(unsigned int)(((uint64_t)x * c.width) / desired_width),
+				(unsigned int)(((uint64_t)y * c.height) / desired_height)
+			));
+		}
+	}
+	c = std::move(res);
+}
+
+static Canvas randomCanvas(unsigned int width, unsigned int height, std::mt19937& rng)
+{
+	Canvas c(width, height);
+	for (auto& px : c.pixels)
+	{
+		px = Rgb((uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng());
+	}
+	return c;
+}
+
+static unsigned int failures = 0;
+
+static void expectEqual(const char* what, const Canvas& a, const Canvas& b)
+{
+	if (a.width != b.width || a.height != b.height || a.pixels != b.pixels)
+	{
+		std::printf("FAIL %s\n", what);
+		++failures;
+	}
+}
+
+// Offsets near the edges and "negative" ones (wrapped unsigned), so clipping is exercised on every side.
+static unsigned int randomOffset(unsigned int size, std::mt19937& rng)
+{
+	return (unsigned int)((int)(rng() % (size + 40)) - 20);
+}
+
+static void check()
+{
+	std::mt19937 rng(1337);
+	for (int i = 0; i != 500; ++i)
+	{
+		const Canvas base = randomCanvas(1 + rng() % 70, 1 + rng() % 70, rng);
+		const Rgb colour((uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng());
+
+		Canvas a = base, b = base;
+		a.fill(colour);
+		refFill(b, colour);
+		expectEqual("fill", a, b);
+
+		const unsigned int x = randomOffset(base.width, rng), y = randomOffset(base.height, rng);
+		const unsigned int w = rng() % 90, h = rng() % 90;
+		a = base; b = base;
+		a.addRect(x, y, w, h, colour);
+		refAddRect(b, x, y, w, h, colour);
+		expectEqual("addRect", a, b);
+
+		const Canvas overlay = randomCanvas(rng() % 90, rng() % 90, rng);
+		a = base; b = base;
+		a.addCanvas(x, y, overlay);
+		refAddCanvas(b, x, y, overlay);
+		expectEqual("addCanvas", a, b);
+
+		const std::u32string text = U"Hello, World! 0123456789 äöü";
+		const RasterFont& font = (i & 1) ? RasterFont::simple8() : RasterFont::simple5();
+		a = base; b = base;
+		a.addText(x, y, text, font);
+		refAddText(b, x, y, text, font);
+		expectEqual("addText", a, b);
+
+		a = base; b = base;
+		a.addText(x, y, "Hello, World! 0123456789 \xC3\xA4\xC3\xB6\xC3\xBC", font);
+		refAddText(b, x, y, text, font);
+		expectEqual("addText (UTF-8)", a, b);
+
+		const unsigned int dw = rng() % 150, dh = rng() % 150;
+		a = base; b = base;
+		a.resizeNearestNeighbour(dw, dh);
+		refResizeNearestNeighbour(b, dw, dh);
+		expectEqual("resizeNearestNeighbour", a, b);
+	}
+
+	// Pin the column mapping: 3 -> 7 columns must pick source columns 0 0 0 1 1 2 2.
+	Canvas row(3, 1);
+	row.pixels = { Rgb(0, 0, 0), Rgb(1, 1, 1), Rgb(2, 2, 2) };
+	row.resizeNearestNeighbour(7, 1);
+	const uint8_t expected[] = { 0, 0, 0, 1, 1, 2, 2 };
+	for (unsigned int x = 0; x != 7; ++x)
+	{
+		if (row.get(x, 0).r != expected[x])
+		{
+			std::printf("FAIL resizeNearestNeighbour column mapping at %u\n", x);
+			++failures;
+		}
+	}
+}
+
+template <typename F>
+static double time(int iterations, F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i != iterations; ++i)
+	{
+		f();
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations * 1e3;
+}
+
+template <typename F, typename G>
+static void bench(const char* name, int iterations, F&& f, G&& ref)
+{
+	const double ms = time(iterations, f);
+	const double ref_ms = time(iterations, ref);
+	std::printf("%-30s %9.3f ms  (per-pixel: %9.3f ms, %5.1fx)\n", name, ms, ref_ms, ref_ms / ms);
+}
+
+int main()
+{
+	check();
+	std::printf("%s\n", failures == 0 ? "All checks passed." : "Checks FAILED.");
+
+	std::mt19937 rng(1);
+	Canvas canvas(1920, 1080);
+	const Canvas sprite = randomCanvas(256, 256, rng);
+	const Canvas photo = randomCanvas(640, 360, rng);
+	const std::u32string text = U"The quick brown fox jumps over the lazy dog. 0123456789";
+	const Rgb colour(10, 20, 30);
+
+	bench("fill 1920x1080", 50, [&] { canvas.fill(colour); }, [&] { refFill(canvas, colour); });
+	bench("addRect 800x600", 50, [&] { canvas.addRect(100, 100, 800, 600, colour); }, [&] { refAddRect(canvas, 100, 100, 800, 600, colour); });
+	bench("addCanvas 256x256", 500, [&] { canvas.addCanvas(100, 100, sprite); }, [&] { refAddCanvas(canvas, 100, 100, sprite); });
+	bench("addText 100 lines", 20, [&]
+	{
+		for (unsigned int y = 0; y != 1000; y += 10)
+		{
+			canvas.addText(0, y, text, RasterFont::simple8());
+		}
+	}, [&]
+	{
+		for (unsigned int y = 0; y != 1000; y += 10)
+		{
+			refAddText(canvas, 0, y, text, RasterFont::simple8());
+		}
+	});
+	bench("resizeNN 640x360->1920x1080", 10, [&]
+	{
+		Canvas c = photo;
+		c.resizeNearestNeighbour(1920, 1080);
+	}, [&]
+	{
+		Canvas c = photo;
+		refResizeNearestNeighbour(c, 1920, 1080);
+	});
+	bench("resizeNN 640x360->333x187", 100, [&]
+	{
+		Canvas c = photo;
+		c.resizeNearestNeighbour(333, 187);
+	}, [&]
+	{
+		Canvas c = photo;
+		refResizeNearestNeighbour(c, 333, 187);
+	});
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+// Fuzzes UTF-8 validation and transcoding against a reference decoder on every SIMD path, then measures throughput on ASCII, mixed and CJK text.
+// The offset checks guard utf8_find_invalid_from_block, which has to rescan from the right place when a vector finds an error.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include <soup/unicode.hpp>
+
+#include "../SimdPaths.hpp"
+
+using namespace soup;
+
+// Offset of the first ill-formed sequence, decoding naively and then checking the code point's range.
+static size_t referenceFindInvalid(const std::string& str)
+{
+	const auto data = (const uint8_t*)str.data();
+	const size_t size = str.size();
+	size_t i = 0;
+	while (i != size)
+	{
+		uint32_t c = data[i];
+		size_t len;
+		uint32_t min;
+		if (c < 0x80)
+		{
+			++i;
+			continue;
+		}
+		else if ((c & 0xE0) == 0xC0)
+		{
+			len = 2;
+			c &= 0x1F;
+			min = 0x80;
+		}
+		else if ((c & 0xF0) == 0xE0)
+		{
+			len = 3;
+			c &= 0x0F;
+			min = 0x800;
+		}
+		else if ((c & 0xF8) == 0xF0)
+		{
+			len = 4;
+			c &= 0x07;
+			min = 0x10000;
+		}
+		else
+		{
+			return i;
+		}
+		if (size - i < len)
+		{
+			return i;
+		}
+		for (size_t j = 1; j != len; ++j)
+		{
+			if (!UTF8_IS_CONTINUATION(data[i + j]))
+			{
+				return i;
+			}
+			c = (c << 6) | (data[i + j] & 0x3F);
+		}
+		if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+		{
+			return i;
+		}
+		i += len;
+	}
+	return unicode::npos;
+}
+
+// The per-character decoding that utf8_to_utf32 used before.
+static std::u32string referenceToUtf32(const std::string& str)
+{
+	std::u32string res;
+	for (auto it = str.cbegin(); it != str.cend(); )
+	{
+		res.push_back(unicode::utf8_to_utf32_char(it, str.cend()));
+	}
+	return res;
+}
+
+static const char* const pieces[] = {
+	"a",
+	"hello world, ",
+	"The quick brown fox jumps over the lazy dog. ",
+	"\xC3\xA9", // U+00E9
+	"\xE4\xB8\xAD", // U+4E2D
+	"\xF0\x9F\x98\x80", // U+1F600
+	"\xEF\xBF\xBF", // U+FFFF
+	"\xF4\x8F\xBF\xBF", // U+10FFFF
+	"\xED\x9F\xBF", // U+D7FF, just below the surrogates
+	"\xE0\xA0\x80", // U+0800, smallest 3-byte
+	"\xF0\x90\x80\x80", // U+10000, smallest 4-byte
+};
+
+static unsigned int fuzz(const SimdPath& path, std::mt19937& rng)
+{
+	unsigned int failures = 0;
+	for (int t = 0; t != 100000; ++t)
+	{
+		std::string str;
+		const int count = rng() % 40;
+		for (int k = 0; k != count; ++k)
+		{
+			str.append(pieces[rng() % (sizeof(pieces) / sizeof(*pieces))]);
+		}
+		if ((rng() & 1) && !str.empty())
+		{
+			for (int k = 1 + rng() % 3; k != 0; --k)
+			{
+				str[rng() % str.size()] = (char)rng();
+			}
+		}
+
+		const size_t expected = referenceFindInvalid(str);
+		const size_t actual = unicode::utf8_find_invalid(str.data(), str.size());
+		if (actual != expected)
+		{
+			if (failures++ < 10)
+			{
+				std::printf("FAIL %s: utf8_find_invalid on %zu bytes returned %zu, expected %zu\n", path.name, str.size(), actual, expected);
+			}
+			continue;
+		}
+
+		std::u32string utf32;
+		UTF16_STRING_TYPE utf16;
+		size_t error_offset = 0;
+		if (expected == unicode::npos)
+		{
+			const std::u32string ref = referenceToUtf32(str);
+			if (!unicode::utf8_to_utf32_strict(str, utf32) || utf32 != ref
+				|| !unicode::utf8_to_utf16_strict(str, utf16) || utf16 != unicode::utf32_to_utf16(ref)
+				|| unicode::utf8_to_utf32(str) != ref
+				)
+			{
+				if (failures++ < 10)
+				{
+					std::printf("FAIL %s: transcoding %zu valid bytes\n", path.name, str.size());
+				}
+			}
+		}
+		else
+		{
+			if (unicode::utf8_to_utf32_strict(str, utf32, &error_offset) || error_offset != expected || !utf32.empty()
+				|| unicode::utf8_to_utf16_strict(str, utf16, &error_offset) || error_offset != expected || !utf16.empty()
+				|| unicode::utf8_to_utf32(str) != referenceToUtf32(str)
+				)
+			{
+				if (failures++ < 10)
+				{
+					std::printf("FAIL %s: strict transcoding of invalid input (offset %zu)\n", path.name, expected);
+				}
+			}
+		}
+	}
+	return failures;
+}
+
+template <typename F>
+static double throughput(const std::string& str, int iterations, F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i != iterations; ++i)
+	{
+		f();
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return (double)str.size() * iterations / seconds / 1e6;
+}
+
+static std::string repeat(const char* piece, size_t size)
+{
+	std::string str;
+	while (str.size() < size)
+	{
+		str.append(piece);
+	}
+	return str;
+}
+
+int main()
+{
+	std::mt19937 rng(7);
+	unsigned int failures = 0;
+	for (const auto& path : simd_paths)
+	{
+		if (!useSimdPath(path))
+		{
+			std::printf("Skipping %s, not supported by this CPU.\n", path.name);
+			continue;
+		}
+		failures += fuzz(path, rng);
+	}
+	std::printf("%s\n", failures == 0 ? "All checks passed." : "Checks FAILED.");
+
+	const std::pair<const char*, std::string> inputs[] = {
+		{ "ascii", repeat("The quick brown fox jumps over the lazy dog. ", 16 << 20) },
+		{ "mixed", repeat("caf\xC3\xA9 na\xC3\xAFve r\xC3\xA9sum\xC3\xA9, \xE4\xB8\xAD\xE6\x96\x87 ok ", 16 << 20) },
+		{ "cjk", repeat("\xE4\xB8\xAD\xE6\x96\x87\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", 16 << 20) },
+	};
+	std::printf("MB/s         validate  to_utf32  to_utf16  (per-char to_utf32)\n");
+	for (const auto& [name, str] : inputs)
+	{
+		const double per_char = throughput(str, 2, [&] { (void)referenceToUtf32(str); });
+		for (const auto& path : simd_paths)
+		{
+			if (!useSimdPath(path))
+			{
+				continue;
+			}
+			const double validate = throughput(str, 10, [&] { (void)unicode::utf8_validate(str); });
+			const double to_utf32 = throughput(str, 4, [&] { (void)unicode::utf8_to_utf32(str); });
+			const double to_utf16 = throughput(str, 4, [&] { UTF16_STRING_TYPE out; (void)unicode::utf8_to_utf16_strict(str, out); });
+			std::printf("%-5s %-6s %8.0f  %8.0f  %8.0f  (%.0f)\n", name, path.name, validate, to_utf32, to_utf16, per_char);
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}